@@ -47,6 +47,11 @@
     `FILE*` for writing to file might imply some allocations "behind
     the scenes", but, that's out of our control.
 
+    If you wish to know where the time goes during the conversion,
+    define `XBM_FORMAT_STATS` (everywhere you include this header) and
+    register a callback with xbm_format_set_stats_callback(). Without
+    it, there is no instrumentation at all.
+
     There is currently no support for loading an XBM image from a file,
     though it's not very hard and can be added if the need arises.
 
@@ -264,6 +269,163 @@ int img_to_xbm_file_ex(unsigned char const*   data,
                        float                  alpha_threshold,
                        FILE*                  f);
 
+/** A rectangle in a bitmap, used for the bounding box of the set
+    (`1`) pixels. The @p x and @p y are the column and row of the
+    top-left pixel of the rectangle.
+    */
+struct xbm_box {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+/** The same as img_to_xbm_ex(), but, while converting, it also finds
+    the bounding box of the set pixels and writes it to @p box, so
+    you don't have to call xbm_bounding_box() afterwards.
+
+    If there are no set pixels, @p box will be all zeros. If @p box
+    is `NULL`, this is the same as img_to_xbm_ex().
+
+    @precondition x%8 == 0
+    @precondition y%8 == 0
+
+    @return 0: OK, otherwise error, failed to convert.
+    */
+int img_to_xbm_bbox_ex(unsigned char const*   data,
+                       int                    x,
+                       int                    y,
+                       int                    n,
+                       unsigned char*         xbm,
+                       enum img_to_xbm_option opt,
+                       float                  color_threshold,
+                       float                  alpha_threshold,
+                       struct xbm_box*        box);
+
+/** Returns the number of set (`1`) pixels in the XBM bitmap @p xbm
+    with the dimensions @p x (width) and @p y (height). Useful to
+    know the "ink coverage" of an image.
+
+    This counts 64 pixels at a time where the compiler has 64-bit
+    integers. On x86, the hardware popcount instruction is only used
+    if enabled (with GCC/Clang `-mpopcnt` or `-march=` some CPU that
+    has it, with MSVC `/arch:AVX`), otherwise a few shifts and masks
+    are used instead.
+
+    @precondition x%8 == 0
+    @precondition y%8 == 0
+    */
+size_t xbm_popcount(unsigned char const* xbm, int x, int y);
+
+/** Finds the bounding box of the set (`1`) pixels in the XBM bitmap
+    @p xbm with the dimensions @p x (width) and @p y (height) and
+    writes it to @p box. This is the smallest rectangle which holds
+    all the set pixels, thus, cropping to it trims the blank margins.
+
+    If there are no set pixels, @p box will be all zeros.
+
+    @precondition x%8 == 0
+    @precondition y%8 == 0
+
+    @return 0: OK, -1: no set pixels in the bitmap.
+    */
+int xbm_bounding_box(unsigned char const* xbm, int x, int y, struct xbm_box* box);
+
+/** Returns the number of bytes needed to store the XBM bitmap
+    cropped to the @p box, that is, the memory you need to provide
+    to xbm_crop().
+    */
+size_t xbm_bytes_for_box(struct xbm_box const* box);
+
+/** Copies the part of the XBM bitmap @p xbm with the dimensions
+    @p x (width) and @p y (height) given by the @p box to @p cropped,
+    which will be a new XBM bitmap with the width and height of the
+    @p box.
+
+    As always in XBM, each row of the cropped bitmap starts at a new
+    byte, so, if the width of the @p box is not a multiple of 8, the
+    "extra" bits at the end of each row are set to `0`. The other
+    functions of this library expect the sizes to be multiples of 8,
+    so you may want to make the @p box larger to get such a result.
+
+    @precondition x%8 == 0
+    @precondition box is inside the bitmap
+
+    @return 0: OK, otherwise error, failed to crop.
+    */
+int xbm_crop(unsigned char const*  xbm,
+             int                   x,
+             int                   y,
+             struct xbm_box const* box,
+             unsigned char*        cropped);
+
+
+#if defined(XBM_FORMAT_STATS)
+
+/** The type of the "time" measurements in the statistics.
+
+    By default, these are nanoseconds from the POSIX monotonic clock
+    (`clock_gettime(CLOCK_MONOTONIC)`) or, if that is not available
+    (for example, in a strict C mode, without `_POSIX_C_SOURCE`), from
+    the C11 `timespec_get()`. If neither is available, `clock()` is
+    used, but, that is CPU time, so it doesn't include the time spent
+    waiting for I/O, and is usually too coarse to be of much use.
+
+    If you wish to measure in CPU cycles, or use some other clock,
+    define the macro `XBM_FORMAT_STATS_CLOCK()` to expand to an
+    expression yielding the current "tick" (for example, `__rdtsc()`)
+    before including this header file with `XBM_FORMAT_IMPLEMENTATION`
+    defined.
+    */
+typedef unsigned long long xbm_format_tick;
+
+/** Statistics of one call of a converting function. These are only
+    available if `XBM_FORMAT_STATS` is defined (in all the files that
+    include this header), otherwise there is no instrumentation at
+    all, so it has no cost.
+    */
+struct xbm_format_stats {
+    /** Time spent deciding on the pixels (thresholding) */
+    xbm_format_tick threshold_ticks;
+    /** Time spent formatting the bytes as text (only for files) */
+    xbm_format_tick format_ticks;
+    /** Time spent writing to the file (only for files) */
+    xbm_format_tick io_ticks;
+    /** Time spent in the whole call */
+    xbm_format_tick total_ticks;
+    /** Number of (source) pixels converted */
+    unsigned long long pixels;
+    /** Number of bytes of the XBM bitmap produced */
+    unsigned long long bytes;
+    /** Number of bits that were set to `1` in the XBM bitmap */
+    unsigned long long set_bits;
+    /** Number of bytes (characters) written to the file (only for files) */
+    unsigned long long bytes_written;
+};
+
+/** The callback to be invoked at the end of each conversion.  The
+    @p func is the name of the function which did the conversion, the
+    @p stats are its statistics and the @p user_data is what was
+    given to xbm_format_set_stats_callback().
+    */
+typedef void (*xbm_format_stats_callback)(char const*                    func,
+                                          struct xbm_format_stats const* stats,
+                                          void* user_data);
+
+/** Sets the @p cb to be invoked at the end of each conversion, that
+    is, each call of img_to_xbm_ex(), img_to_xbm_bbox_ex() or
+    img_to_xbm_file_ex() (the other functions call one of these, so
+    the callback is invoked exactly once for each of them, too). The
+    @p user_data will be passed to the callback. Pass `NULL` for
+    @p cb to stop the callbacks.
+
+    This is a global setting, so it's not thread safe. Set it before
+    starting the conversions in other threads.
+    */
+void xbm_format_set_stats_callback(xbm_format_stats_callback cb, void* user_data);
+
+#endif /* defined(XBM_FORMAT_STATS) */
+
 #ifdef __cplusplus
 }
 #endif
@@ -274,6 +436,215 @@ int img_to_xbm_file_ex(unsigned char const*   data,
 #if defined(XBM_FORMAT_IMPLEMENTATION)
 
 #include <assert.h>
+#include <string.h>
+
+
+/* The number of bytes (of XBM bitmap) that are formatted as text
+   before being written to the file at once. */
+#define XBM_FORMAT_CHUNK 16
+
+
+/* We scan the bitmaps a word at a time, 64 bits where the compiler
+   has them, otherwise `unsigned long`, which is at least 32 bits and
+   is there in C89, too. */
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wlong-long"
+typedef unsigned long long xbm_format_word;
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#include <intrin.h>
+typedef unsigned __int64 xbm_format_word;
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)
+typedef unsigned long long xbm_format_word;
+#else
+typedef unsigned long xbm_format_word;
+#endif
+#define XBM_FORMAT_WORD_BYTES ((int)sizeof(xbm_format_word))
+#define XBM_FORMAT_WORD_BITS (8 * XBM_FORMAT_WORD_BYTES)
+
+
+/* Loads (up to) a word of a bitmap from @p p, so that the first
+   pixel is the lowest bit, regardless of the endianness. */
+static xbm_format_word xbm_format_load_word(unsigned char const* p, int nbytes)
+{
+    xbm_format_word rslt = 0;
+    assert(nbytes <= XBM_FORMAT_WORD_BYTES);
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) \
+    || defined(_MSC_VER)
+    memcpy(&rslt, p, nbytes);
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    memcpy(&rslt, p, nbytes);
+    rslt = __builtin_bswap64(rslt);
+#else
+    {
+        int i;
+        for (i = 0; i < nbytes; ++i) {
+            rslt |= (xbm_format_word)p[i] << (8 * i);
+        }
+    }
+#endif
+    return rslt;
+}
+
+
+/* Loads the word of the @p row (of @p stride bytes) starting at the
+   byte @p i, which is a whole word, except, maybe, at the row end. */
+static xbm_format_word xbm_format_load_row_word(unsigned char const* row, int i, int stride)
+{
+    return (stride - i >= XBM_FORMAT_WORD_BYTES)
+               ? xbm_format_load_word(row + i, XBM_FORMAT_WORD_BYTES)
+               : xbm_format_load_word(row + i, stride - i);
+}
+
+
+/* The popcount builtin is a library call unless the target has the
+   instruction, which, on x86, you need to enable (`-mpopcnt`,
+   `-march=native`...), so we use our own otherwise. */
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__POPCNT__) || defined(__aarch64__))
+#define xbm_format_popcount(w) __builtin_popcountll(w)
+#elif defined(_MSC_VER) && defined(_M_X64) && defined(__AVX__)
+#define xbm_format_popcount(w) ((int)__popcnt64(w))
+#else
+static int xbm_format_popcount(xbm_format_word w)
+{
+    xbm_format_word const all = ~(xbm_format_word)0;
+    w = w - ((w >> 1) & (all / 3));
+    w = (w & (all / 5)) + ((w >> 2) & (all / 5));
+    w = (w + (w >> 4)) & (all / 17);
+    return (int)((w * (all / 255)) >> (XBM_FORMAT_WORD_BITS - 8));
+}
+#endif
+
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define xbm_format_lowest_bit(w) __builtin_ctzll(w)
+#define xbm_format_highest_bit(w) (XBM_FORMAT_WORD_BITS - 1 - __builtin_clzll(w))
+
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+
+/* Precondition: w != 0 */
+static int xbm_format_lowest_bit(xbm_format_word w)
+{
+    unsigned long rslt;
+    _BitScanForward64(&rslt, w);
+    return (int)rslt;
+}
+
+
+/* Precondition: w != 0 */
+static int xbm_format_highest_bit(xbm_format_word w)
+{
+    unsigned long rslt;
+    _BitScanReverse64(&rslt, w);
+    return (int)rslt;
+}
+
+#else
+
+/* Precondition: w != 0 */
+static int xbm_format_lowest_bit(xbm_format_word w)
+{
+    int rslt = 0;
+    for (; (w & 0xff) == 0; w >>= 8) {
+        rslt += 8;
+    }
+    for (; (w & 1) == 0; w >>= 1) {
+        ++rslt;
+    }
+    return rslt;
+}
+
+
+/* Precondition: w != 0 */
+static int xbm_format_highest_bit(xbm_format_word w)
+{
+    int rslt = 0;
+    for (; w > 0xff; w >>= 8) {
+        rslt += 8;
+    }
+    for (; w > 1; w >>= 1) {
+        ++rslt;
+    }
+    return rslt;
+}
+
+#endif
+
+
+#if defined(XBM_FORMAT_STATS)
+
+#if !defined(XBM_FORMAT_STATS_CLOCK)
+#include <time.h>
+
+/* We prefer a wall clock, as CPU time (as in `clock()`) does not
+   include the time spent waiting for I/O, and is also too coarse. */
+static xbm_format_tick xbm_format_stats_clock(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (xbm_format_tick)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#elif defined(TIME_UTC)
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (xbm_format_tick)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+    return (xbm_format_tick)clock() * (1000000000ULL / CLOCKS_PER_SEC);
+#endif
+}
+
+#define XBM_FORMAT_STATS_CLOCK() xbm_format_stats_clock()
+#endif
+
+static xbm_format_stats_callback xbm_format_stats_cb;
+static void*                     xbm_format_stats_user_data;
+
+
+void xbm_format_set_stats_callback(xbm_format_stats_callback cb, void* user_data)
+{
+    xbm_format_stats_cb        = cb;
+    xbm_format_stats_user_data = user_data;
+}
+
+
+static void xbm_format_stats_report(char const* func, struct xbm_format_stats* stats)
+{
+    if (xbm_format_stats_cb != NULL) {
+        xbm_format_stats_cb(func, stats, xbm_format_stats_user_data);
+    }
+}
+
+/* Declares the statistics of a function, must be the last declaration */
+#define XBM_FORMAT_STATS_VARS                  \
+    struct xbm_format_stats xbm_stats_ = { 0, 0, 0, 0, 0, 0, 0, 0 }; \
+    xbm_format_tick         xbm_stats_start_ = XBM_FORMAT_STATS_CLOCK(); \
+    xbm_format_tick         xbm_stats_t_;
+#define XBM_FORMAT_STATS_START() (xbm_stats_t_ = XBM_FORMAT_STATS_CLOCK())
+#define XBM_FORMAT_STATS_STOP(phase) \
+    (xbm_stats_.phase##_ticks += XBM_FORMAT_STATS_CLOCK() - xbm_stats_t_)
+#define XBM_FORMAT_STATS_BYTE(byte)                                       \
+    (++xbm_stats_.bytes,                                                  \
+     xbm_stats_.pixels += 8,                                              \
+     xbm_stats_.set_bits += xbm_format_popcount(byte))
+#define XBM_FORMAT_STATS_WRITTEN(n) \
+    ((n) > 0 ? (void)(xbm_stats_.bytes_written += (n)) : (void)0)
+#define XBM_FORMAT_STATS_REPORT(func)                                   \
+    (xbm_stats_.total_ticks = XBM_FORMAT_STATS_CLOCK() - xbm_stats_start_, \
+     xbm_format_stats_report((func), &xbm_stats_))
+
+#else
+
+#define XBM_FORMAT_STATS_VARS
+#define XBM_FORMAT_STATS_START() ((void)0)
+#define XBM_FORMAT_STATS_STOP(phase) ((void)0)
+#define XBM_FORMAT_STATS_BYTE(byte) ((void)0)
+#define XBM_FORMAT_STATS_WRITTEN(n) ((void)(n))
+#define XBM_FORMAT_STATS_REPORT(func) ((void)(func))
+
+#endif /* defined(XBM_FORMAT_STATS) */
 
 
 size_t xbm_bytes_for_dimensions(int x, int y)
@@ -342,36 +713,146 @@ static int img_to_xbm_decide_bit(unsigned char const*   data,
 }
 
 
-int img_to_xbm_ex(unsigned char const*   data,
-                  int                    x,
-                  int                    y,
-                  int                    n,
-                  unsigned char*         xbm,
-                  enum img_to_xbm_option opt,
-                  float                  color_threshold,
-                  float                  alpha_threshold)
+static void xbm_format_set_box(struct xbm_box* box,
+                               int             left,
+                               int             right,
+                               int             top,
+                               int             bottom)
+{
+    if (top < 0) {
+        box->x      = 0;
+        box->y      = 0;
+        box->width  = 0;
+        box->height = 0;
+    }
+    else {
+        box->x      = left;
+        box->y      = top;
+        box->width  = right - left + 1;
+        box->height = bottom - top + 1;
+    }
+}
+
+
+static unsigned char img_to_xbm_decide_byte(unsigned char const*   data,
+                                            int                    x,
+                                            int                    ix,
+                                            int                    iy,
+                                            int                    n,
+                                            enum img_to_xbm_option opt,
+                                            float                  color_thold,
+                                            float                  alpha_thold)
+{
+    unsigned char byte = 0;
+    int           pos;
+    for (pos = 0; pos < 8; ++pos) {
+        const int offset = (iy * x + ix + pos) * n;
+        const int bit    = img_to_xbm_decide_bit(
+            data, offset, n, opt, color_thold, alpha_thold);
+        byte |= bit << pos;
+    }
+    return byte;
+}
+
+
+/* Converts to @p xbm and, if @p box is not `NULL`, finds the bounding
+   box. The @p func is the name of the calling API function, for the
+   statistics. */
+static int img_to_xbm_convert(unsigned char const*   data,
+                              int                    x,
+                              int                    y,
+                              int                    n,
+                              unsigned char*         xbm,
+                              enum img_to_xbm_option opt,
+                              float                  color_threshold,
+                              float                  alpha_threshold,
+                              struct xbm_box*        box,
+                              char const*            func)
 {
     int iy;
+    int left   = x;
+    int right  = -1;
+    int top    = -1;
+    int bottom = -1;
+    XBM_FORMAT_STATS_VARS
     assert(data != NULL);
     assert(xbm != NULL);
+    XBM_FORMAT_STATS_START();
     for (iy = 0; iy < y; ++iy) {
         int ix;
         for (ix = 0; ix < x; ix += 8) {
-            unsigned char byte = 0;
-            int           pos;
-            for (pos = 0; pos < 8; ++pos) {
-                const int offset = (iy * x + ix + pos) * n;
-                const int bit    = img_to_xbm_decide_bit(
-                    data, offset, n, opt, color_threshold, alpha_threshold);
-                byte |= bit << pos;
-            }
+            const unsigned char byte = img_to_xbm_decide_byte(
+                data, x, ix, iy, n, opt, color_threshold, alpha_threshold);
+            XBM_FORMAT_STATS_BYTE(byte);
             xbm[(iy * x + ix) / 8] = byte;
+            if ((box != NULL) && (byte != 0)) {
+                if (ix + xbm_format_lowest_bit(byte) < left) {
+                    left = ix + xbm_format_lowest_bit(byte);
+                }
+                if (ix + xbm_format_highest_bit(byte) > right) {
+                    right = ix + xbm_format_highest_bit(byte);
+                }
+                if (top < 0) {
+                    top = iy;
+                }
+                bottom = iy;
+            }
         }
     }
+    XBM_FORMAT_STATS_STOP(threshold);
+    if (box != NULL) {
+        xbm_format_set_box(box, left, right, top, bottom);
+    }
+    XBM_FORMAT_STATS_REPORT(func);
     return 0;
 }
 
 
+int img_to_xbm_ex(unsigned char const*   data,
+                  int                    x,
+                  int                    y,
+                  int                    n,
+                  unsigned char*         xbm,
+                  enum img_to_xbm_option opt,
+                  float                  color_threshold,
+                  float                  alpha_threshold)
+{
+    return img_to_xbm_convert(data,
+                              x,
+                              y,
+                              n,
+                              xbm,
+                              opt,
+                              color_threshold,
+                              alpha_threshold,
+                              NULL,
+                              "img_to_xbm_ex");
+}
+
+
+int img_to_xbm_bbox_ex(unsigned char const*   data,
+                       int                    x,
+                       int                    y,
+                       int                    n,
+                       unsigned char*         xbm,
+                       enum img_to_xbm_option opt,
+                       float                  color_threshold,
+                       float                  alpha_threshold,
+                       struct xbm_box*        box)
+{
+    return img_to_xbm_convert(data,
+                              x,
+                              y,
+                              n,
+                              xbm,
+                              opt,
+                              color_threshold,
+                              alpha_threshold,
+                              box,
+                              "img_to_xbm_bbox_ex");
+}
+
+
 int img_to_xbm_filename(unsigned char const* data,
                         int                  x,
                         int                  y,
@@ -442,32 +923,193 @@ int img_to_xbm_file_ex(unsigned char const*   data,
                        FILE*                  f)
 {
     int iy;
+    int written;
+    XBM_FORMAT_STATS_VARS
     assert(data != NULL);
     assert(imgname != NULL);
     assert(f != NULL);
     assert(x % 8 == 0);
     assert(y % 8 == 0);
 
-    fprintf(f, "#define %s_width %d\n", imgname, x);
-    fprintf(f, "#define %s_height %d\n", imgname, y);
-    fprintf(f, "static unsigned char %s_bits[] = {", imgname);
+    XBM_FORMAT_STATS_START();
+    written = fprintf(f,
+                      "#define %s_width %d\n"
+                      "#define %s_height %d\n"
+                      "static unsigned char %s_bits[] = {",
+                      imgname,
+                      x,
+                      imgname,
+                      y,
+                      imgname);
+    XBM_FORMAT_STATS_STOP(io);
+    XBM_FORMAT_STATS_WRITTEN(written);
 
     for (iy = 0; iy < y; ++iy) {
         int ix;
-        fprintf(f, "%s\n    ", (0 == iy) ? "" : ",");
-        for (ix = 0; ix < x; ix += 8) {
-            unsigned char byte = 0;
-            int           pos;
-            for (pos = 0; pos < 8; ++pos) {
-                const int offset = (iy * x + ix + pos) * n;
-                const int bit    = img_to_xbm_decide_bit(
-                    data, offset, n, opt, color_threshold, alpha_threshold);
-                byte |= bit << pos;
+        for (ix = 0; ix < x; ix += 8 * XBM_FORMAT_CHUNK) {
+            unsigned char bytes[XBM_FORMAT_CHUNK];
+            /* Each byte is at most ", 0xNN", plus the row start ",\n    " */
+            char   text[XBM_FORMAT_CHUNK * 6 + 8];
+            size_t len    = 0;
+            int    nbytes = (x - ix) / 8;
+            int    i;
+            if (nbytes > XBM_FORMAT_CHUNK) {
+                nbytes = XBM_FORMAT_CHUNK;
+            }
+
+            XBM_FORMAT_STATS_START();
+            for (i = 0; i < nbytes; ++i) {
+                bytes[i] = img_to_xbm_decide_byte(
+                    data, x, ix + 8 * i, iy, n, opt, color_threshold, alpha_threshold);
+                XBM_FORMAT_STATS_BYTE(bytes[i]);
+            }
+            XBM_FORMAT_STATS_STOP(threshold);
+
+            XBM_FORMAT_STATS_START();
+            if (0 == ix) {
+                len += sprintf(text, "%s\n    ", (0 == iy) ? "" : ",");
+            }
+            for (i = 0; i < nbytes; ++i) {
+                len += sprintf(text + len,
+                               "%s0x%02x",
+                               (0 == ix && 0 == i) ? "" : ", ",
+                               bytes[i]);
             }
-            fprintf(f, "%s0x%02x", (0 == ix) ? "" : ", ", byte);
+            XBM_FORMAT_STATS_STOP(format);
+
+            XBM_FORMAT_STATS_START();
+            written = (int)fwrite(text, 1, len, f);
+            XBM_FORMAT_STATS_STOP(io);
+            XBM_FORMAT_STATS_WRITTEN(written);
+        }
+    }
+    XBM_FORMAT_STATS_START();
+    written = fputs("};\n", f) >= 0 ? 3 : 0;
+    XBM_FORMAT_STATS_STOP(io);
+    XBM_FORMAT_STATS_WRITTEN(written);
+    XBM_FORMAT_STATS_REPORT("img_to_xbm_file_ex");
+    return 0;
+}
+
+
+size_t xbm_popcount(unsigned char const* xbm, int x, int y)
+{
+    size_t const         nbytes = xbm_bytes_for_dimensions(x, y);
+    size_t               rslt   = 0;
+    unsigned char const* p;
+    unsigned char const* end;
+    assert(xbm != NULL);
+    /* x%8 == 0 and y%8 == 0, so there are whole words */
+    assert(nbytes % XBM_FORMAT_WORD_BYTES == 0);
+    end = xbm + nbytes;
+    for (p = xbm; p < end; p += XBM_FORMAT_WORD_BYTES) {
+        rslt += xbm_format_popcount(xbm_format_load_word(p, XBM_FORMAT_WORD_BYTES));
+    }
+    return rslt;
+}
+
+
+int xbm_bounding_box(unsigned char const* xbm, int x, int y, struct xbm_box* box)
+{
+    int const stride = x / 8;
+    int       left   = x;
+    int       right  = -1;
+    int       top    = -1;
+    int       bottom = -1;
+    int       iy;
+    assert(xbm != NULL);
+    assert(box != NULL);
+    assert(x % 8 == 0);
+    assert(y % 8 == 0);
+
+    for (iy = 0; iy < y; ++iy) {
+        unsigned char const* row = xbm + iy * stride;
+        xbm_format_word      w   = 0;
+        int                  i;
+
+        /* Find the first set pixel, a word of them at a time */
+        for (i = 0; i < stride; i += XBM_FORMAT_WORD_BYTES) {
+            w = xbm_format_load_row_word(row, i, stride);
+            if (w != 0) {
+                break;
+            }
+        }
+        if (0 == w) {
+            continue;
+        }
+        if (8 * i + xbm_format_lowest_bit(w) < left) {
+            left = 8 * i + xbm_format_lowest_bit(w);
+        }
+        if (top < 0) {
+            top = iy;
+        }
+        bottom = iy;
+
+        /* Now find the last one, from the end of the row */
+        for (i = (stride - 1) / XBM_FORMAT_WORD_BYTES * XBM_FORMAT_WORD_BYTES;;
+             i -= XBM_FORMAT_WORD_BYTES) {
+            w = xbm_format_load_row_word(row, i, stride);
+            if (w != 0) {
+                break;
+            }
+        }
+        if (8 * i + xbm_format_highest_bit(w) > right) {
+            right = 8 * i + xbm_format_highest_bit(w);
+        }
+    }
+
+    xbm_format_set_box(box, left, right, top, bottom);
+    return (top < 0) ? -1 : 0;
+}
+
+
+size_t xbm_bytes_for_box(struct xbm_box const* box)
+{
+    assert(box != NULL);
+    assert(box->width >= 0);
+    assert(box->height >= 0);
+    return (size_t)((box->width + 7) / 8) * box->height;
+}
+
+
+int xbm_crop(unsigned char const*  xbm,
+             int                   x,
+             int                   y,
+             struct xbm_box const* box,
+             unsigned char*        cropped)
+{
+    int const stride = x / 8;
+    int       out_stride;
+    int       first;
+    int       shift;
+    int       last_bits;
+    int       iy;
+    assert(xbm != NULL);
+    assert(box != NULL);
+    assert(cropped != NULL);
+    assert(x % 8 == 0);
+    assert((box->x >= 0) && (box->width >= 0) && (box->x + box->width <= x));
+    assert((box->y >= 0) && (box->height >= 0) && (box->y + box->height <= y));
+    out_stride = (box->width + 7) / 8;
+    first      = box->x / 8;
+    shift      = box->x % 8;
+    last_bits  = box->width % 8;
+
+    for (iy = 0; iy < box->height; ++iy) {
+        unsigned char const* row = xbm + (box->y + iy) * stride + first;
+        unsigned char*       out = cropped + iy * out_stride;
+        int                  i;
+        for (i = 0; i < out_stride; ++i) {
+            unsigned int byte = row[i] >> shift;
+            if ((shift != 0) && (first + i + 1 < stride)) {
+                byte |= (unsigned int)row[i + 1] << (8 - shift);
+            }
+            out[i] = (unsigned char)byte;
+        }
+        if ((out_stride > 0) && (last_bits != 0)) {
+            out[out_stride - 1] &= (1u << last_bits) - 1;
         }
     }
-    fputs("};\n", f);
     return 0;
 }
 
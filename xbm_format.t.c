@@ -153,12 +153,98 @@ void test_med_fname()
 }
 
 
+void test_popcount()
+{
+    unsigned char wide[16 * 8] = { 0 };
+    assert(32 == xbm_popcount(xbm_simp, 8, 8));
+    assert(54 == xbm_popcount(xbm_med, 16, 8));
+    assert(0 == xbm_popcount(wide, 128, 8));
+    wide[0]               = 0x01;
+    wide[sizeof wide - 1] = 0xff;
+    assert(9 == xbm_popcount(wide, 128, 8));
+}
+
+
+void test_popcount_naive()
+{
+    unsigned char xbm[24 * 8];
+    size_t        naive = 0;
+    size_t        i;
+    for (i = 0; i < sizeof xbm; ++i) {
+        int bit;
+        xbm[i] = (unsigned char)(i * 37 + (i >> 3));
+        for (bit = 0; bit < 8; ++bit) {
+            naive += (xbm[i] >> bit) & 1;
+        }
+    }
+    assert(naive == xbm_popcount(xbm, 192, 8));
+}
+
+
+void test_bounding_box()
+{
+    unsigned char  wide[16 * 8] = { 0 };
+    unsigned char  xbm[sizeof xbm_med];
+    struct xbm_box box;
+
+    assert(0 == xbm_bounding_box(xbm_simp, 8, 8, &box));
+    assert((0 == box.x) && (0 == box.y) && (7 == box.width) && (8 == box.height));
+
+    assert(0 == img_to_xbm_bbox_ex(img_med,
+                                   16,
+                                   8,
+                                   4,
+                                   xbm,
+                                   img_to_xbm_color_or_alpha,
+                                   XBM_FORMAT_THRESHOLD_COLOR,
+                                   XBM_FORMAT_THRESHOLD_ALPHA,
+                                   &box));
+    assert(memcmp(xbm, xbm_med, sizeof xbm) == 0);
+    assert((0 == box.x) && (0 == box.y) && (15 == box.width) && (8 == box.height));
+
+    assert(-1 == xbm_bounding_box(wide, 128, 8, &box));
+    assert((0 == box.x) && (0 == box.y) && (0 == box.width) && (0 == box.height));
+
+    wide[5 * 16 + 12] = 0x10; /* column 100 */
+    wide[6 * 16 + 8]  = 0x40; /* column 70 */
+    assert(0 == xbm_bounding_box(wide, 128, 8, &box));
+    assert((70 == box.x) && (5 == box.y) && (31 == box.width) && (2 == box.height));
+
+    /* Rows of 9 bytes, a whole word and a bit */
+    memset(wide, 0, sizeof wide);
+    wide[1 * 9 + 8] = 0x80; /* column 71 */
+    wide[3 * 9 + 0] = 0x02; /* column 1 */
+    assert(0 == xbm_bounding_box(wide, 72, 8, &box));
+    assert((1 == box.x) && (1 == box.y) && (71 == box.width) && (3 == box.height));
+}
+
+
+void test_crop()
+{
+    unsigned char const xbm[] = { 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x02,
+                                  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    unsigned char const expected[] = { 0x01, 0x40 };
+    unsigned char       cropped[sizeof expected];
+    struct xbm_box      box;
+
+    assert(0 == xbm_bounding_box(xbm, 16, 8, &box));
+    assert((3 == box.x) && (2 == box.y) && (7 == box.width) && (2 == box.height));
+    assert(sizeof cropped == xbm_bytes_for_box(&box));
+    assert(0 == xbm_crop(xbm, 16, 8, &box, cropped));
+    assert(memcmp(cropped, expected, sizeof cropped) == 0);
+}
+
+
 int main()
 {
     test_simp();
     test_simp_fname();
     test_med();
     test_med_fname();
+    test_popcount();
+    test_popcount_naive();
+    test_bounding_box();
+    test_crop();
 
     return 0;
 }
@@ -0,0 +1,123 @@
+/* The statistics have to be enabled for the whole translation unit,
+   so they are tested separately from the rest, in their own program.
+
+   The clock is a simple counter, so that the results are deterministic.
+*/
+static unsigned long long ticks;
+
+#define XBM_FORMAT_STATS
+#define XBM_FORMAT_STATS_CLOCK() (++ticks)
+#define XBM_FORMAT_IMPLEMENTATION
+#include "xbm_format.h"
+
+#include <string.h>
+
+
+#define X 'x', 'x', 'x', 'x',
+#define _ ' ', ' ', ' ', ' ',
+#define __() _
+
+unsigned char const img_simp[] = {
+    X _ X _ X _ X __() //
+    X _ X _ X _ X __() //
+    X _ X _ X _ X __() //
+    X _ X _ X _ X __() //
+    X _ X _ X _ X __() //
+    X _ X _ X _ X __() //
+    X _ X _ X _ X __() //
+    X _ X _ X _ X __() //
+};
+
+
+struct stats_seen {
+    int                     calls;
+    char const*             func;
+    struct xbm_format_stats stats;
+};
+
+
+void stats_cb(char const* func, struct xbm_format_stats const* stats, void* user_data)
+{
+    struct stats_seen* seen = (struct stats_seen*)user_data;
+    ++seen->calls;
+    seen->func  = func;
+    seen->stats = *stats;
+}
+
+
+void test_stats_mem()
+{
+    struct stats_seen seen = { 0, NULL, { 0, 0, 0, 0, 0, 0, 0, 0 } };
+    unsigned char     xbm[8];
+
+    xbm_format_set_stats_callback(stats_cb, &seen);
+
+    assert(0 == img_to_xbm(img_simp, 8, 8, 4, xbm));
+    assert(1 == seen.calls);
+    assert(0 == strcmp(seen.func, "img_to_xbm_ex"));
+    assert(64 == seen.stats.pixels);
+    assert(sizeof xbm == seen.stats.bytes);
+    assert(32 == seen.stats.set_bits);
+    assert(0 == seen.stats.bytes_written);
+    assert(seen.stats.threshold_ticks > 0);
+    assert(0 == seen.stats.format_ticks);
+    assert(0 == seen.stats.io_ticks);
+    assert(seen.stats.total_ticks > seen.stats.threshold_ticks);
+
+    assert(0 == img_to_xbm_bbox_ex(img_simp,
+                                   8,
+                                   8,
+                                   4,
+                                   xbm,
+                                   img_to_xbm_color_or_alpha,
+                                   XBM_FORMAT_THRESHOLD_COLOR,
+                                   XBM_FORMAT_THRESHOLD_ALPHA,
+                                   NULL));
+    assert(2 == seen.calls);
+    assert(0 == strcmp(seen.func, "img_to_xbm_bbox_ex"));
+
+    xbm_format_set_stats_callback(NULL, NULL);
+    assert(0 == img_to_xbm(img_simp, 8, 8, 4, xbm));
+    assert(2 == seen.calls);
+}
+
+
+void test_stats_file()
+{
+    /* 256 pixels wide, so that each row is more than one chunk */
+    static unsigned char img[256 * 8 * 4];
+    struct stats_seen    seen = { 0, NULL, { 0, 0, 0, 0, 0, 0, 0, 0 } };
+    FILE*                f    = tmpfile();
+    size_t               i;
+
+    assert(f != NULL);
+    for (i = 0; i < sizeof img; i += 4 * 3) {
+        img[i] = img[i + 1] = img[i + 2] = img[i + 3] = 0xff;
+    }
+
+    xbm_format_set_stats_callback(stats_cb, &seen);
+    assert(0 == img_to_xbm_file(img, 256, 8, 4, "wide", f));
+    xbm_format_set_stats_callback(NULL, NULL);
+
+    assert(1 == seen.calls);
+    assert(0 == strcmp(seen.func, "img_to_xbm_file_ex"));
+    assert(256 * 8 == seen.stats.pixels);
+    assert(256 / 8 * 8 == seen.stats.bytes);
+    assert((256 * 8 + 2) / 3 == seen.stats.set_bits);
+    assert((unsigned long)ftell(f) == seen.stats.bytes_written);
+    assert(seen.stats.threshold_ticks > 0);
+    assert(seen.stats.format_ticks > 0);
+    assert(seen.stats.io_ticks > 0);
+    assert(seen.stats.total_ticks
+           > seen.stats.threshold_ticks + seen.stats.format_ticks + seen.stats.io_ticks);
+    fclose(f);
+}
+
+
+int main()
+{
+    test_stats_mem();
+    test_stats_file();
+
+    return 0;
+}